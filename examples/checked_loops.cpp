@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Times tight loops whose cost is dominated by the overflow checks, to compare
+// the backends and compilers that a build can select.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef __INTELLISENSE__
+#include <beman/bounds_test/bounds_test.hpp>
+#else
+import beman.bounds_test;
+#endif
+
+namespace bt = beman::bounds_test;
+
+template <typename F>
+void bench(const char* name, std::size_t n, F f) {
+  constexpr int reps = 20;
+  std::uint64_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; ++i)
+    sink += f();
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << name << ": " << elapsed.count() / (reps * n) << " ns/element (" << sink << ")\n";
+}
+
+int main() {
+  constexpr std::size_t n = 1 << 22;
+  std::mt19937_64 rng{42};
+
+  std::vector<std::int64_t> wide(n);
+  for (auto& v : wide)
+    v = static_cast<std::int64_t>(rng() >> 24);
+
+  std::vector<std::int32_t> a(n), b(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = static_cast<std::int32_t>(rng());
+    b[i] = static_cast<std::int32_t>(rng());
+  }
+
+  std::vector<std::uint16_t> small(n);
+  for (auto& v : small)
+    v = static_cast<std::uint16_t>(rng() % 300);
+
+  std::vector<std::int16_t> deltas(n);
+  for (auto& v : deltas)
+    v = static_cast<std::int16_t>(rng());
+
+  // Branch on every check, exit on the first failure
+  bench("checked sum (int64)", n, [&] {
+    std::int64_t sum = 0;
+    for (auto v : wide) {
+      if (!bt::can_add_in_place(sum, v)) break;
+      sum += v;
+    }
+    return static_cast<std::uint64_t>(sum);
+  });
+
+  // The check result is consumed as a value rather than a branch
+  bench("count add overflows (int32)", n, [&] {
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < n; ++i)
+      count += !bt::can_add(a[i], b[i]);
+    return count;
+  });
+
+  // Narrow in-place multiply, restarting the product whenever it would overflow
+  bench("restarting product (uint16)", n, [&] {
+    std::uint16_t product = 1;
+    std::uint64_t restarts = 0;
+    for (auto v : small) {
+      if (bt::can_multiply_in_place(product, v) && v) {
+        product = static_cast<std::uint16_t>(product * v);
+      } else {
+        product = 1;
+        ++restarts;
+      }
+    }
+    return restarts;
+  });
+
+  // Mixed-type in-place add: the int16 operand widens losslessly to the int32
+  // total, and the total restarts whenever it would overflow
+  bench("restarting sum (int32 += int16)", n, [&] {
+    std::int32_t total = 0;
+    std::uint64_t restarts = 0;
+    for (auto v : deltas) {
+      if (bt::can_add_in_place(total, v)) {
+        total += v;
+      } else {
+        total = v;
+        ++restarts;
+      }
+    }
+    return restarts + static_cast<std::uint32_t>(total);
+  });
+}
@@ -0,0 +1,361 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Validates a raw little-endian column of fixed-width integers before it is
+// loaded. The file is memory-mapped and scanned once, in parallel, reporting
+// whether the column can be narrowed, whether its sum and product overflow the
+// column type, and how much headroom is left at either end of the type.
+//
+// Usage: column_validator <i8|i16|i32|i64|u8|u16|u32|u64> <file> [threads]
+//
+// The file must be a regular file; pipes and devices are rejected, since their
+// size is not known up front.
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __INTELLISENSE__
+#include <beman/bounds_test/bounds_test.hpp>
+#else
+import beman.bounds_test;
+#endif
+
+namespace bt = beman::bounds_test;
+
+class mapped_file {
+public:
+  explicit mapped_file(const char* path) {
+    fd_ = ::open(path, O_RDONLY);
+    if (fd_ < 0) return;
+
+    struct stat st;
+    if (::fstat(fd_, &st) < 0) {
+      // Keep fstat's errno for the caller rather than close's
+      const int err = errno;
+      ::close(fd_);
+      fd_ = -1;
+      errno = err;
+      return;
+    }
+    // Pipes, terminals and devices report a size of 0 or less than they hold,
+    // so they would pass as an empty or truncated column
+    if (!S_ISREG(st.st_mode)) {
+      ::close(fd_);
+      fd_ = -1;
+      regular_ = false;
+      return;
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (!size_) return;
+
+    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (p != MAP_FAILED) data_ = static_cast<const std::byte*>(p);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  ~mapped_file() {
+    if (data_) ::munmap(const_cast<std::byte*>(data_), size_);
+    if (fd_ >= 0) ::close(fd_);
+  }
+
+  // An empty file is valid but has no mapping
+  bool ok() const noexcept { return fd_ >= 0 && (data_ || !size_); }
+  // False if the path was opened but is not a regular file
+  bool regular() const noexcept { return regular_; }
+  const std::byte* data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+
+private:
+  int fd_ = -1;
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+  bool regular_ = true;
+};
+
+template <std::integral T>
+T load_le(const std::byte* p) noexcept {
+  T v;
+  std::memcpy(&v, p, sizeof(T));
+  if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+    auto u = static_cast<std::make_unsigned_t<T>>(v);
+    std::make_unsigned_t<T> r = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i, u >>= 8)
+      r = static_cast<std::make_unsigned_t<T>>((r << 8) | (u & 0xff));
+    v = static_cast<T>(r);
+  }
+  return v;
+}
+
+// Exact sum of 64-bit values as a 128-bit two's complement number, so the
+// result does not depend on how the column is split between threads
+struct wide_sum {
+  std::uint64_t lo = 0;
+  std::uint64_t hi = 0;
+
+  template <std::integral T>
+  void add(T v) noexcept {
+    std::uint64_t h = 0;
+    if constexpr (std::signed_integral<T>) h = v < 0 ? ~std::uint64_t{0} : 0;
+    add_words(static_cast<std::uint64_t>(v), h);
+  }
+
+  void merge(const wide_sum& o) noexcept { add_words(o.lo, o.hi); }
+
+  template <std::integral T>
+  bool fits() const noexcept {
+    if constexpr (std::signed_integral<T>) {
+      // Within the 64-bit range when hi is just the sign extension of lo
+      const auto v = static_cast<std::int64_t>(lo);
+      return hi == (v < 0 ? ~std::uint64_t{0} : 0) && bt::can_convert<T>(v);
+    } else {
+      return !hi && bt::can_convert<T>(lo);
+    }
+  }
+
+private:
+  void add_words(std::uint64_t l, std::uint64_t h) noexcept {
+    lo += l;
+    hi += h + (lo < l);
+  }
+};
+
+// Exact product as a sign and a 64-bit magnitude. The magnitude of a product of
+// nonzero integers never decreases, so once it overflows the product cannot
+// fit in any column type, whatever the order of the factors.
+struct wide_product {
+  std::uint64_t magnitude = 1;
+  bool negative = false;
+  bool overflows = false;
+
+  template <std::integral T>
+  void add(T v) noexcept {
+    std::uint64_t m = static_cast<std::uint64_t>(v);
+    if constexpr (std::signed_integral<T>) {
+      if (v < 0) {
+        m = ~m + 1;
+        negative = !negative;
+      }
+    }
+    multiply(m);
+  }
+
+  void merge(const wide_product& o) noexcept {
+    negative = negative != o.negative;
+    overflows = overflows || o.overflows;
+    multiply(o.magnitude);
+  }
+
+  template <std::integral T>
+  bool fits() const noexcept {
+    if (overflows) return false;
+    // -magnitude fits in T when magnitude - 1 does not exceed T's maximum
+    return negative ? std::signed_integral<T> && bt::can_convert<T>(magnitude - 1) : bt::can_convert<T>(magnitude);
+  }
+
+  template <std::integral T>
+  T value() const noexcept {
+    if (negative) return static_cast<T>(-static_cast<std::int64_t>(magnitude - 1) - 1);
+    return static_cast<T>(magnitude);
+  }
+
+private:
+  void multiply(std::uint64_t m) noexcept {
+    if (overflows) return;
+    if (bt::can_multiply_in_place(magnitude, m))
+      magnitude *= m;
+    else
+      overflows = true;
+  }
+};
+
+// Reports whether the sum and product of the whole column fit in T. Both are
+// computed exactly, so a running total that overflows part-way but comes back
+// into range still fits, and the result is the same for any thread count.
+template <std::integral T>
+struct column_stats {
+  std::size_t count = 0;
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::lowest();
+  wide_sum sum;
+  wide_product product;
+  bool has_zero = false;
+
+  void add(T v) noexcept {
+    ++count;
+    min = std::min(min, v);
+    max = std::max(max, v);
+    sum.add(v);
+    if (!v) has_zero = true;
+    product.add(v);
+  }
+
+  void merge(const column_stats& o) noexcept {
+    if (!o.count) return;
+    count += o.count;
+    min = std::min(min, o.min);
+    max = std::max(max, o.max);
+    has_zero = has_zero || o.has_zero;
+    sum.merge(o.sum);
+    product.merge(o.product);
+  }
+
+  bool sum_fits() const noexcept { return sum.fits<T>(); }
+
+  // A zero anywhere in the column makes the product zero, however large the
+  // other factors are
+  bool product_fits() const noexcept { return has_zero || product.fits<T>(); }
+};
+
+template <std::integral T>
+column_stats<T> scan_chunk(const std::byte* first, const std::byte* last) noexcept {
+  ::madvise(const_cast<std::byte*>(first), static_cast<std::size_t>(last - first), MADV_SEQUENTIAL);
+
+  column_stats<T> s;
+  for (; first != last; first += sizeof(T))
+    s.add(load_le<T>(first));
+  return s;
+}
+
+template <std::integral T>
+column_stats<T> scan(const mapped_file& file, unsigned threads) {
+  // Chunks start on page boundaries so madvise() applies to whole pages and,
+  // since pages are a multiple of sizeof(T), no element straddles two chunks
+  const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const std::size_t per_thread = (file.size() + threads - 1) / threads;
+  const std::size_t chunk = std::max(page, (per_thread + page - 1) / page * page);
+
+  std::vector<column_stats<T>> partials((file.size() + chunk - 1) / chunk);
+  std::vector<std::thread> workers;
+  workers.reserve(partials.size());
+
+  for (std::size_t i = 0; i < partials.size(); ++i) {
+    const std::byte* first = file.data() + i * chunk;
+    const std::byte* last = file.data() + std::min(file.size(), (i + 1) * chunk);
+    workers.emplace_back([&partials, i, first, last] { partials[i] = scan_chunk<T>(first, last); });
+  }
+
+  column_stats<T> total;
+  for (std::size_t i = 0; i < workers.size(); ++i) {
+    workers[i].join();
+    total.merge(partials[i]);
+  }
+  return total;
+}
+
+template <std::integral T>
+auto widen(T v) noexcept {
+  if constexpr (std::signed_integral<T>)
+    return static_cast<long long>(v);
+  else
+    return static_cast<unsigned long long>(v);
+}
+
+template <std::integral R, std::integral T>
+void report_narrowing(std::string_view name, const column_stats<T>& s) {
+  const bool fits = bt::can_convert<R>(s.min) && bt::can_convert<R>(s.max);
+  std::cout << "\t" << name << ": " << (fits ? "yes" : "no") << "\n";
+}
+
+template <std::integral T>
+void report(const column_stats<T>& s) {
+  using U = std::make_unsigned_t<T>;
+  constexpr T lmin = std::numeric_limits<T>::lowest();
+  constexpr T lmax = std::numeric_limits<T>::max();
+
+  std::cout << "elements: " << s.count << "\n";
+  if (!s.count) return;
+
+  std::cout << "min: " << widen(s.min) << "\n"
+            << "max: " << widen(s.max) << "\n"
+            << "headroom below min: " << widen(static_cast<U>(static_cast<U>(s.min) - static_cast<U>(lmin))) << "\n"
+            << "headroom above max: " << widen(static_cast<U>(static_cast<U>(lmax) - static_cast<U>(s.max))) << "\n";
+
+  std::cout << "sum: ";
+  if (!s.sum_fits())
+    std::cout << "overflows\n";
+  else
+    std::cout << widen(static_cast<T>(s.sum.lo)) << "\n";
+
+  std::cout << "product: ";
+  if (!s.product_fits())
+    std::cout << "overflows\n";
+  else
+    std::cout << widen(s.has_zero ? T{0} : s.product.template value<T>()) << "\n";
+
+  std::cout << "can convert to:\n";
+  report_narrowing<std::int8_t>("i8", s);
+  report_narrowing<std::int16_t>("i16", s);
+  report_narrowing<std::int32_t>("i32", s);
+  report_narrowing<std::int64_t>("i64", s);
+  report_narrowing<std::uint8_t>("u8", s);
+  report_narrowing<std::uint16_t>("u16", s);
+  report_narrowing<std::uint32_t>("u32", s);
+  report_narrowing<std::uint64_t>("u64", s);
+}
+
+template <std::integral T>
+int validate(const mapped_file& file, unsigned threads) {
+  if (file.size() % sizeof(T)) {
+    std::cerr << "File size " << file.size() << " is not a multiple of " << sizeof(T) << " bytes\n";
+    return 1;
+  }
+  report(scan<T>(file, threads));
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3 || argc > 4) {
+    std::cerr << "Usage: " << argv[0] << " <i8|i16|i32|i64|u8|u16|u32|u64> <file> [threads]\n";
+    return 1;
+  }
+
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  if (argc == 4) {
+    std::string_view arg = argv[3];
+    auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), threads);
+    if (ec != std::errc{} || ptr != arg.data() + arg.size() || !threads) {
+      std::cerr << "Invalid thread count: " << arg << "\n";
+      return 1;
+    }
+  }
+
+  mapped_file file(argv[2]);
+  if (!file.ok()) {
+    if (!file.regular())
+      std::cerr << argv[2] << ": not a regular file\n";
+    else
+      std::cerr << argv[2] << ": " << std::strerror(errno) << "\n";
+    return 1;
+  }
+
+  std::string_view type = argv[1];
+  if (type == "i8") return validate<std::int8_t>(file, threads);
+  if (type == "i16") return validate<std::int16_t>(file, threads);
+  if (type == "i32") return validate<std::int32_t>(file, threads);
+  if (type == "i64") return validate<std::int64_t>(file, threads);
+  if (type == "u8") return validate<std::uint8_t>(file, threads);
+  if (type == "u16") return validate<std::uint16_t>(file, threads);
+  if (type == "u32") return validate<std::uint32_t>(file, threads);
+  if (type == "u64") return validate<std::uint64_t>(file, threads);
+
+  std::cerr << "Unknown column type: " << type << "\n";
+  return 1;
+}
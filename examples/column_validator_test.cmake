@@ -0,0 +1,57 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+# Checks that column_validator reports the same sum and product whatever the
+# number of threads, for columns whose running totals overflow part-way
+# through but end in range, and that it rejects inputs that are not regular
+# files.
+#
+# Usage: cmake -DVALIDATOR=<path> -DWORK_DIR=<dir> -P column_validator_test.cmake
+
+string(ASCII 1 plus_1)
+string(ASCII 2 plus_2)
+string(ASCII 100 plus_100)
+string(ASCII 255 minus_1)
+string(ASCII 254 minus_2)
+string(ASCII 192 minus_64)
+string(ASCII 156 minus_100)
+
+# An i8 column split across two 4096-byte pages. Each page sums to 100 or 0,
+# but a single running sum reaches 200 at the start of the second page.
+string(REPEAT "${plus_1}${minus_1}" 2046 pairs)
+set(first_page "${plus_100}${plus_2}${minus_1}${minus_1}${pairs}")
+set(second_page "${plus_100}${minus_100}${pairs}${plus_1}${minus_1}")
+file(WRITE ${WORK_DIR}/sum.i8 "${first_page}${second_page}")
+
+# -2 * -64 overflows i8, but the product of the whole column is -128
+file(WRITE ${WORK_DIR}/product.i8 "${minus_2}${minus_64}${minus_1}")
+
+function(check_column FILE EXPECTED)
+  foreach(threads 1 2 3)
+    execute_process(
+      COMMAND ${VALIDATOR} i8 ${WORK_DIR}/${FILE} ${threads}
+      OUTPUT_VARIABLE output
+      RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+      message(FATAL_ERROR "column_validator failed on ${FILE} with ${threads} threads")
+    endif()
+    string(REGEX MATCH "sum: [^\n]*\nproduct: [^\n]*" totals "${output}")
+    if(NOT totals STREQUAL EXPECTED)
+      message(FATAL_ERROR "${FILE} with ${threads} threads:\n${totals}\nexpected:\n${EXPECTED}")
+    endif()
+  endforeach()
+endfunction()
+
+check_column(sum.i8 "sum: 100\nproduct: overflows")
+check_column(product.i8 "sum: -67\nproduct: -128")
+
+# Anything other than a regular file is rejected rather than read as empty
+execute_process(
+  COMMAND ${VALIDATOR} i8 ${WORK_DIR}
+  OUTPUT_QUIET
+  ERROR_VARIABLE errors
+  RESULT_VARIABLE result
+)
+if(result EQUAL 0 OR NOT errors MATCHES "not a regular file")
+  message(FATAL_ERROR "column_validator accepted the directory ${WORK_DIR}")
+endif()
@@ -1,7 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 module;
 
+#include <beman/bounds_test/bit_pack.hpp>
 #include <beman/bounds_test/bounds_test.hpp>
+#include <beman/bounds_test/views.hpp>
 
 export module beman.bounds_test;
 
@@ -10,6 +12,8 @@ export namespace beman::bounds_test {
 /* clang-format off */
 using ::beman::bounds_test::can_convert;
 using ::beman::bounds_test::can_convert_modular;
+using ::beman::bounds_test::required_bits;
+using ::beman::bounds_test::can_fit_bits;
 
 using ::beman::bounds_test::can_increment;
 using ::beman::bounds_test::can_decrement;
@@ -36,6 +40,10 @@ using ::beman::bounds_test::can_bitwise_or;
 
 using ::beman::bounds_test::can_compare;
 
+using ::beman::bounds_test::rounding;
+using ::beman::bounds_test::can_muldiv;
+using ::beman::bounds_test::try_muldiv;
+
 using ::beman::bounds_test::can_add_modular;
 using ::beman::bounds_test::can_subtract_modular;
 using ::beman::bounds_test::can_multiply_modular;
@@ -64,6 +72,51 @@ using ::beman::bounds_test::can_shift_right_in_place_modular;
 using ::beman::bounds_test::can_bitwise_and_in_place_modular;
 using ::beman::bounds_test::can_bitwise_xor_in_place_modular;
 using ::beman::bounds_test::can_bitwise_or_in_place_modular;
+
+using ::beman::bounds_test::assume_can_convert;
+using ::beman::bounds_test::assume_can_increment;
+using ::beman::bounds_test::assume_can_decrement;
+using ::beman::bounds_test::assume_can_negate;
+using ::beman::bounds_test::assume_can_add;
+using ::beman::bounds_test::assume_can_subtract;
+using ::beman::bounds_test::assume_can_multiply;
+using ::beman::bounds_test::assume_can_divide;
+using ::beman::bounds_test::assume_can_add_in_place;
+using ::beman::bounds_test::assume_can_subtract_in_place;
+using ::beman::bounds_test::assume_can_multiply_in_place;
+using ::beman::bounds_test::assume_can_divide_in_place;
+
+using ::beman::bounds_test::expect_can_convert;
+using ::beman::bounds_test::expect_can_increment;
+using ::beman::bounds_test::expect_can_decrement;
+using ::beman::bounds_test::expect_can_negate;
+using ::beman::bounds_test::expect_can_add;
+using ::beman::bounds_test::expect_can_subtract;
+using ::beman::bounds_test::expect_can_multiply;
+using ::beman::bounds_test::expect_can_divide;
+using ::beman::bounds_test::expect_can_add_in_place;
+using ::beman::bounds_test::expect_can_subtract_in_place;
+using ::beman::bounds_test::expect_can_multiply_in_place;
+using ::beman::bounds_test::expect_can_divide_in_place;
+
+using ::beman::bounds_test::pack_lanes;
+using ::beman::bounds_test::pack_block_size;
+using ::beman::bounds_test::max_required_bits;
+using ::beman::bounds_test::can_pack;
+using ::beman::bounds_test::packed_words;
+using ::beman::bounds_test::pack_bits;
+using ::beman::bounds_test::unpack_bits;
+
+using ::beman::bounds_test::checked_transform_view;
+using ::beman::bounds_test::checked_partial_sum_view;
 /* clang-format on */
 
 } // namespace beman::bounds_test
+
+export namespace beman::bounds_test::views {
+
+using ::beman::bounds_test::views::checked_transform;
+using ::beman::bounds_test::views::checked_partial_sum;
+using ::beman::bounds_test::views::checked_cast;
+
+} // namespace beman::bounds_test::views
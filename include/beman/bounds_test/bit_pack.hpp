@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_BOUNDS_TEST_BIT_PACK_HPP
+#define BEMAN_BOUNDS_TEST_BIT_PACK_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <beman/bounds_test/bounds_test.hpp>
+
+// Block bit-width queries and a fixed-width bit-packing codec.
+//
+// Packed data is laid out in blocks of pack_block_size values. Within a block,
+// value i belongs to lane i % pack_lanes, and each lane is packed LSB-first
+// into its own sequence of 64-bit words, with the lanes' words interleaved.
+// Every lane then performs the same shifts at the same time, which lets the
+// compiler vectorize packing and unpacking across lanes. A partial final
+// block is padded with zeros.
+
+namespace beman::bounds_test {
+
+inline constexpr std::size_t pack_lanes = 4;
+inline constexpr std::size_t pack_block_size = 64 * pack_lanes;
+
+namespace detail {
+
+template <std::integral T>
+constexpr auto sign_folded(T v) noexcept {
+  using U = std::make_unsigned_t<T>;
+  // Maps negative values to their complement, without a branch, so that the
+  // bit width of the result is one less than required_bits
+  if constexpr (std::signed_integral<T>) return static_cast<U>(v ^ (v >> std::numeric_limits<T>::digits));
+  return static_cast<U>(v);
+}
+
+template <int N>
+inline constexpr std::uint64_t low_bits_mask = N >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << N) - 1;
+
+// Row I of a block holds value I of every lane. Its bit offset within each
+// lane is a constant, so every shift below is by an immediate.
+template <int N, std::size_t I>
+constexpr void pack_row(const std::uint64_t* in, std::uint64_t* out) noexcept {
+  constexpr std::size_t word = I * N / 64;
+  constexpr int shift = I * N % 64;
+
+  in += I * pack_lanes;
+  for (std::size_t j = 0; j < pack_lanes; ++j)
+    out[word * pack_lanes + j] |= in[j] << shift;
+  if constexpr (shift + N > 64) {
+    for (std::size_t j = 0; j < pack_lanes; ++j)
+      out[(word + 1) * pack_lanes + j] |= in[j] >> (64 - shift);
+  }
+}
+
+template <int N, std::size_t I>
+constexpr void unpack_row(const std::uint64_t* in, std::uint64_t* out) noexcept {
+  constexpr std::size_t word = I * N / 64;
+  constexpr int shift = I * N % 64;
+
+  out += I * pack_lanes;
+  for (std::size_t j = 0; j < pack_lanes; ++j)
+    out[j] = (in[word * pack_lanes + j] >> shift) & low_bits_mask<N>;
+  if constexpr (shift + N > 64) {
+    for (std::size_t j = 0; j < pack_lanes; ++j)
+      out[j] |= (in[(word + 1) * pack_lanes + j] << (64 - shift)) & low_bits_mask<N>;
+  }
+}
+
+template <int N, std::size_t... I>
+constexpr void pack_block(const std::uint64_t* in, std::uint64_t* out, std::index_sequence<I...>) noexcept {
+  std::fill(out, out + N * pack_lanes, std::uint64_t{0});
+  (pack_row<N, I>(in, out), ...);
+}
+
+template <int N, std::size_t... I>
+constexpr void unpack_block(const std::uint64_t* in, std::uint64_t* out, std::index_sequence<I...>) noexcept {
+  (unpack_row<N, I>(in, out), ...);
+}
+
+} // namespace detail
+
+// The smallest N for which can_pack<N>(values) holds, or 0 for an empty span
+template <std::integral T, std::size_t Extent>
+  requires(!std::same_as<std::remove_cv_t<T>, bool>)
+constexpr int max_required_bits(std::span<T, Extent> values) noexcept {
+  using V = std::remove_cv_t<T>;
+  if (values.empty()) return 0;
+
+  // OR-reduce instead of taking the maximum of required_bits per value, so the
+  // loop has no dependency on bit scans and vectorizes
+  std::make_unsigned_t<V> folded = 0;
+  for (V v : values)
+    folded |= detail::sign_folded(v);
+  return static_cast<int>(std::bit_width(folded)) + (std::signed_integral<V> ? 1 : 0);
+}
+
+template <int N, std::integral T, std::size_t Extent>
+  requires(!std::same_as<std::remove_cv_t<T>, bool>)
+constexpr bool can_pack(std::span<T, Extent> values) noexcept {
+  static_assert(N >= 0, "bit width must not be negative");
+  return max_required_bits(values) <= N;
+}
+
+// Number of words pack_bits writes for count values of the given bit width
+constexpr std::size_t packed_words(std::size_t count, int bits) noexcept {
+  return (count + pack_block_size - 1) / pack_block_size * static_cast<std::size_t>(bits) * pack_lanes;
+}
+
+// Packs values into N-bit fields. Returns false, without writing to words,
+// if any value fails can_fit_bits<N> or words is too small.
+template <int N, std::integral T, std::size_t Extent>
+  requires(!std::same_as<std::remove_cv_t<T>, bool>)
+constexpr bool pack_bits(std::span<T, Extent> values, std::span<std::uint64_t> words) noexcept {
+  static_assert(N >= 0 && N <= 64, "bit width must be between 0 and 64");
+  if (words.size() < packed_words(values.size(), N)) return false;
+  if (!::beman::bounds_test::can_pack<N>(values)) return false;
+
+  if constexpr (N > 0) {
+    constexpr auto rows = std::make_index_sequence<64>{};
+    std::uint64_t block[pack_block_size];
+    for (std::size_t first = 0; first < values.size(); first += pack_block_size) {
+      const std::size_t n = std::min(pack_block_size, values.size() - first);
+      for (std::size_t i = 0; i < n; ++i)
+        block[i] = static_cast<std::uint64_t>(values[first + i]) & detail::low_bits_mask<N>;
+      std::fill(block + n, block + pack_block_size, std::uint64_t{0});
+
+      detail::pack_block<N>(block, words.data() + first / pack_block_size * N * pack_lanes, rows);
+    }
+  }
+  return true;
+}
+
+// Unpacks values.size() N-bit fields written by pack_bits<N>. Returns false,
+// without writing to values, if words is too small.
+template <int N, std::integral T, std::size_t Extent>
+  requires(!std::is_const_v<T> && !std::same_as<T, bool>)
+constexpr bool unpack_bits(std::span<const std::uint64_t> words, std::span<T, Extent> values) noexcept {
+  static_assert(N >= 0 && N <= std::numeric_limits<T>::digits + std::signed_integral<T>,
+                "bit width must fit in the value type");
+  if (words.size() < packed_words(values.size(), N)) return false;
+
+  if constexpr (N == 0) {
+    std::fill(values.begin(), values.end(), T{0});
+  } else {
+    constexpr auto rows = std::make_index_sequence<64>{};
+    std::uint64_t block[pack_block_size];
+    for (std::size_t first = 0; first < values.size(); first += pack_block_size) {
+      detail::unpack_block<N>(words.data() + first / pack_block_size * N * pack_lanes, block, rows);
+
+      const std::size_t n = std::min(pack_block_size, values.size() - first);
+      for (std::size_t i = 0; i < n; ++i) {
+        if constexpr (std::signed_integral<T> && N < 64) {
+          // Sign-extend from bit N - 1
+          constexpr std::uint64_t sign = std::uint64_t{1} << (N - 1);
+          values[first + i] = static_cast<T>(static_cast<std::int64_t>((block[i] ^ sign) - sign));
+        } else {
+          values[first + i] = static_cast<T>(block[i]);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace beman::bounds_test
+
+#endif // BEMAN_BOUNDS_TEST_BIT_PACK_HPP
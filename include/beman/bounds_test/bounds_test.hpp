@@ -3,8 +3,11 @@
 #ifndef BEMAN_BOUNDS_TEST_BOUNDS_TEST_HPP
 #define BEMAN_BOUNDS_TEST_BOUNDS_TEST_HPP
 
+#include <bit>
 #include <concepts>
+#include <cstdint>
 #include <limits>
+#include <optional>
 #include <utility>
 
 #ifdef __INTELLISENSE__
@@ -41,6 +44,38 @@ constexpr bool can_convert_modular(A /* a */) noexcept {
   return true;
 }
 
+// Number of bits needed to represent a as an integer of the same signedness,
+// counting the sign bit for signed types. This is a count rather than a
+// check, so it is a bit scan rather than a conversion or shift check.
+template <std::integral A>
+  requires(!std::same_as<A, bool>)
+constexpr int required_bits(A a) noexcept {
+  using U = std::make_unsigned_t<A>;
+  if constexpr (std::signed_integral<A>) return static_cast<int>(std::bit_width(static_cast<U>(a < 0 ? ~a : a))) + 1;
+  return static_cast<int>(std::bit_width(static_cast<U>(a)));
+}
+
+// True if a survives a round trip through an N-bit integer of the same
+// signedness. Widths the shift check rejects are at least as wide as A, so
+// every value fits; otherwise the bits above the field must all equal the
+// sign, which is what can_convert checks for the standard widths.
+template <int N, std::integral A>
+  requires(!std::same_as<A, bool>)
+constexpr bool can_fit_bits(A a) noexcept {
+  static_assert(N >= 0, "bit width must not be negative");
+  if constexpr (std::unsigned_integral<A>) {
+    if constexpr (!::beman::bounds_test::detail::can_shift(A{}, N, A{})) return true;
+    else return !(a >> N);
+  } else if constexpr (N == 0) {
+    return false;
+  } else if constexpr (!::beman::bounds_test::detail::can_shift(A{}, N - 1, A{})) {
+    return true;
+  } else {
+    const auto high = a >> (N - 1);
+    return high == 0 || high == -1;
+  }
+}
+
 template <std::integral A>
 constexpr bool can_increment(A a) noexcept {
   return can_add_in_place(a, 1);
@@ -144,6 +179,77 @@ constexpr bool can_bitwise_or(A /* a */, B /* b */) noexcept {
 template <std::integral A, std::integral B>
 constexpr bool can_compare(A a, B b) noexcept;
 
+// Rounding applied to the exact quotient of can_muldiv and try_muldiv. nearest
+// rounds halfway cases away from zero
+enum class rounding { truncate, floor, nearest };
+
+namespace detail {
+
+template <std::integral T>
+constexpr bool is_negative(T v) noexcept {
+  if constexpr (std::signed_integral<T>) return v < 0;
+  return false;
+}
+
+template <std::integral T>
+constexpr std::uint64_t magnitude(T v) noexcept {
+  const auto u = static_cast<std::uint64_t>(v);
+  return is_negative(v) ? 0 - u : u;
+}
+
+// Computes (a * b) / c exactly with a double-width intermediate product
+template <std::integral A, std::integral B, std::integral C, std::integral R>
+constexpr bool muldiv(A a, B b, C c, rounding mode, R& result) noexcept {
+  static_assert(std::numeric_limits<A>::digits <= 64 && std::numeric_limits<B>::digits <= 64 &&
+                    std::numeric_limits<C>::digits <= 64,
+                "muldiv supports operands of up to 64 bits");
+
+  if (!c) return false;
+
+  const bool negative = (is_negative(a) != is_negative(b)) != is_negative(c);
+  const std::uint64_t d = magnitude(c);
+  std::uint64_t q, r;
+  if (!::beman::bounds_test::detail::mul_div_wide(magnitude(a), magnitude(b), d, q, r)) return false;
+
+  bool away_from_zero = false;
+  switch (mode) {
+  case rounding::truncate:
+    break;
+  case rounding::floor:
+    away_from_zero = negative && r;
+    break;
+  case rounding::nearest:
+    away_from_zero = r && r >= d - r;
+    break;
+  }
+  if (away_from_zero && !++q) return false;
+
+  if (negative) {
+    if (q > magnitude(std::numeric_limits<R>::min())) return false;
+    result = static_cast<R>(0 - q);
+    return true;
+  }
+  if (q > static_cast<std::uint64_t>(std::numeric_limits<R>::max())) return false;
+  result = static_cast<R>(q);
+  return true;
+}
+
+} // namespace detail
+
+template <std::integral A, std::integral B, std::integral C>
+constexpr bool can_muldiv(A a, B b, C c, rounding mode = rounding::truncate) noexcept {
+  decltype(a * b / c) result{};
+  return ::beman::bounds_test::detail::muldiv(a, b, c, mode, result);
+}
+
+template <std::integral A, std::integral B, std::integral C>
+constexpr auto try_muldiv(A a, B b, C c, rounding mode = rounding::truncate) noexcept
+    -> std::optional<decltype(a * b / c)> {
+  decltype(a * b / c) result{};
+  if (!::beman::bounds_test::detail::muldiv(a, b, c, mode, result)) return std::nullopt;
+  return result;
+}
+
 template <std::integral A, std::integral B>
 constexpr bool can_add_modular(A a, B b) noexcept {
   if constexpr (std::unsigned_integral<decltype(a + b)>) return true;
@@ -266,6 +372,133 @@ constexpr bool can_bitwise_or_in_place_modular(A /* a */, B /* b */) noexcept {
   return true;
 }
 
+// Optimizer hints. assume_can_* tells the compiler that the check holds, so
+// code after it, including a repeat of the same check, may rely on the
+// operation being in range; the check is asserted in debug builds. With the
+// generic backend, GCC does not fold a repeated multiply check, which is a
+// chain of comparisons and divisions. expect_can_* returns the check, marked
+// as likely.
+
+template <std::integral R, std::integral A>
+constexpr void assume_can_convert(A a) noexcept {
+  if (!can_convert<R>(a)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A>
+constexpr void assume_can_increment(A a) noexcept {
+  if (!can_increment(a)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A>
+constexpr void assume_can_decrement(A a) noexcept {
+  if (!can_decrement(a)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A>
+constexpr void assume_can_negate(A a) noexcept {
+  if (!can_negate(a)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_add(A a, B b) noexcept {
+  if (!can_add(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_subtract(A a, B b) noexcept {
+  if (!can_subtract(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_multiply(A a, B b) noexcept {
+  if (!can_multiply(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_divide(A a, B b) noexcept {
+  if (!can_divide(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_add_in_place(A a, B b) noexcept {
+  if (!can_add_in_place(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_subtract_in_place(A a, B b) noexcept {
+  if (!can_subtract_in_place(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_multiply_in_place(A a, B b) noexcept {
+  if (!can_multiply_in_place(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral A, std::integral B>
+constexpr void assume_can_divide_in_place(A a, B b) noexcept {
+  if (!can_divide_in_place(a, b)) ::beman::bounds_test::detail::unreachable();
+}
+
+template <std::integral R, std::integral A>
+constexpr bool expect_can_convert(A a) noexcept {
+  return ::beman::bounds_test::detail::expect(can_convert<R>(a));
+}
+
+template <std::integral A>
+constexpr bool expect_can_increment(A a) noexcept {
+  return ::beman::bounds_test::detail::expect(can_increment(a));
+}
+
+template <std::integral A>
+constexpr bool expect_can_decrement(A a) noexcept {
+  return ::beman::bounds_test::detail::expect(can_decrement(a));
+}
+
+template <std::integral A>
+constexpr bool expect_can_negate(A a) noexcept {
+  return ::beman::bounds_test::detail::expect(can_negate(a));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_add(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_add(a, b));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_subtract(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_subtract(a, b));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_multiply(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_multiply(a, b));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_divide(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_divide(a, b));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_add_in_place(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_add_in_place(a, b));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_subtract_in_place(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_subtract_in_place(a, b));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_multiply_in_place(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_multiply_in_place(a, b));
+}
+
+template <std::integral A, std::integral B>
+constexpr bool expect_can_divide_in_place(A a, B b) noexcept {
+  return ::beman::bounds_test::detail::expect(can_divide_in_place(a, b));
+}
+
 } // namespace beman::bounds_test
 
 #endif // BEMAN_BOUNDS_TEST_BOUNDS_TEST_HPP
@@ -3,12 +3,37 @@
 #ifndef BEMAN_BOUNDS_TEST_PLAT_COMMON_HPP
 #define BEMAN_BOUNDS_TEST_PLAT_COMMON_HPP
 
+#include <bit>
+#include <cassert>
 #include <concepts>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 
 namespace beman::bounds_test::detail {
 
+// Marks a path the caller has proven is never taken. Callers branch to it on
+// the failed check itself, rather than passing the check in as a bool, so the
+// optimizer sees the same condition it will see in later checks and can fold
+// them. Debug builds assert instead, since reaching it is undefined behavior
+inline void unreachable() noexcept {
+#if !defined(NDEBUG)
+  assert(false && "an assumed check does not hold");
+#elif defined(__GNUC__) || defined(__clang__)
+  __builtin_unreachable();
+#elif defined(_MSC_VER)
+  __assume(false);
+#endif
+}
+
+constexpr bool expect(bool cond) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_expect(cond, true);
+#else
+  return cond;
+#endif
+}
+
 constexpr bool can_div(auto a, auto b, auto c) noexcept {
   using T = decltype(c);
   if constexpr (std::signed_integral<T>) {
@@ -23,6 +48,76 @@ constexpr bool can_shift(auto /* a */, auto b, auto c) noexcept {
   return b < std::numeric_limits<std::make_unsigned_t<decltype(c)>>::digits;
 }
 
+// Portable double-word arithmetic for compilers without a native 128-bit type
+
+constexpr void umul_wide(std::uint64_t a, std::uint64_t b, std::uint64_t& hi, std::uint64_t& lo) noexcept {
+  constexpr std::uint64_t mask = 0xffff'ffff;
+  const std::uint64_t ll = (a & mask) * (b & mask);
+  const std::uint64_t lh = (a & mask) * (b >> 32);
+  const std::uint64_t hl = (a >> 32) * (b & mask);
+  const std::uint64_t hh = (a >> 32) * (b >> 32);
+  const std::uint64_t mid = (ll >> 32) + (lh & mask) + (hl & mask);
+
+  lo = (mid << 32) | (ll & mask);
+  hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+// Divides hi:lo by d, requires hi < d so the quotient fits in 64 bits.
+// Knuth's algorithm D specialized to two 32-bit digits (Hacker's Delight, divlu)
+constexpr std::uint64_t udiv_wide(std::uint64_t hi, std::uint64_t lo, std::uint64_t d, std::uint64_t& r) noexcept {
+  constexpr std::uint64_t base = std::uint64_t{1} << 32;
+  constexpr std::uint64_t mask = base - 1;
+
+  const int s = std::countl_zero(d);
+  d <<= s;
+  const std::uint64_t dn1 = d >> 32;
+  const std::uint64_t dn0 = d & mask;
+
+  const std::uint64_t un32 = s ? (hi << s) | (lo >> (64 - s)) : hi;
+  const std::uint64_t un10 = lo << s;
+  const std::uint64_t un1 = un10 >> 32;
+  const std::uint64_t un0 = un10 & mask;
+
+  std::uint64_t q1 = un32 / dn1;
+  std::uint64_t rhat = un32 - q1 * dn1;
+  while (q1 >= base || q1 * dn0 > base * rhat + un1) {
+    --q1;
+    rhat += dn1;
+    if (rhat >= base) break;
+  }
+
+  const std::uint64_t un21 = un32 * base + un1 - q1 * d;
+  std::uint64_t q0 = un21 / dn1;
+  rhat = un21 - q0 * dn1;
+  while (q0 >= base || q0 * dn0 > base * rhat + un0) {
+    --q0;
+    rhat += dn1;
+    if (rhat >= base) break;
+  }
+
+  r = (un21 * base + un0 - q0 * d) >> s;
+  return q1 * base + q0;
+}
+
+// Computes q and r such that a * b == q * c + r, with r < c. Returns false if
+// the quotient does not fit in 64 bits, which includes c == 0.
+constexpr bool
+mul_div_wide(std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t& q, std::uint64_t& r) noexcept {
+#ifdef __SIZEOF_INT128__
+  __extension__ using uint128_t = unsigned __int128;
+  const uint128_t p = static_cast<uint128_t>(a) * b;
+  if (static_cast<std::uint64_t>(p >> 64) >= c) return false;
+  q = static_cast<std::uint64_t>(p / c);
+  r = static_cast<std::uint64_t>(p % c);
+#else
+  std::uint64_t hi, lo;
+  umul_wide(a, b, hi, lo);
+  if (hi >= c) return false;
+  q = udiv_wide(hi, lo, c, r);
+#endif
+  return true;
+}
+
 } // namespace beman::bounds_test::detail
 
 #endif // BEMAN_BOUNDS_TEST_PLAT_COMMON_HPP
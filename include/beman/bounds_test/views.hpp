@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef BEMAN_BOUNDS_TEST_VIEWS_HPP
+#define BEMAN_BOUNDS_TEST_VIEWS_HPP
+
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <beman/bounds_test/bounds_test.hpp>
+
+// Lazy views which apply a checked operation to each element of a range. Each
+// view ends at the first element whose check fails, and records the failure
+// so it can be told apart from the end of the underlying range.
+
+namespace beman::bounds_test {
+
+namespace detail {
+
+template <typename T>
+inline constexpr bool is_optional = false;
+
+template <typename T>
+inline constexpr bool is_optional<std::optional<T>> = true;
+
+// Views which record whether their last iteration ended early, such as the
+// checked views below. A checked view whose base is one of these reports the
+// base's failures as its own, so an early stop anywhere in a pipeline is
+// visible at the end of it.
+template <typename V>
+concept reports_failure = requires(const V& v) {
+  { v.failed() } -> std::convertible_to<bool>;
+};
+
+// Makes a copy-constructible callable assignable, so views holding one model
+// std::ranges::view
+template <std::copy_constructible T>
+  requires std::is_object_v<T>
+class copyable_box {
+public:
+  constexpr explicit copyable_box(T value) : value_{std::in_place, std::move(value)} {}
+
+  copyable_box(const copyable_box&) = default;
+  copyable_box(copyable_box&&) = default;
+
+  constexpr copyable_box& operator=(const copyable_box& other) {
+    if (this != &other) {
+      if (other.value_)
+        value_.emplace(*other.value_);
+      else
+        value_.reset();
+    }
+    return *this;
+  }
+
+  constexpr copyable_box& operator=(copyable_box&& other) {
+    if (this != &other) {
+      if (other.value_)
+        value_.emplace(std::move(*other.value_));
+      else
+        value_.reset();
+    }
+    return *this;
+  }
+
+  constexpr const T& operator*() const noexcept { return *value_; }
+
+private:
+  std::optional<T> value_;
+};
+
+template <typename Derived>
+struct range_adaptor_closure {
+  template <std::ranges::viewable_range R>
+    requires std::invocable<const Derived&, R>
+  friend constexpr auto operator|(R&& r, const Derived& self) {
+    return self(std::forward<R>(r));
+  }
+};
+
+template <std::integral R>
+struct try_convert {
+  template <std::integral A>
+  constexpr std::optional<R> operator()(A a) const noexcept {
+    if (!::beman::bounds_test::can_convert<R>(a)) return std::nullopt;
+    return static_cast<R>(a);
+  }
+};
+
+} // namespace detail
+
+// Yields *fn(x) for each element x, where fn returns a std::optional. Ends at
+// the first element for which fn returns an empty optional.
+template <std::ranges::input_range V, std::copy_constructible F>
+  requires std::ranges::view<V> && std::is_object_v<F> &&
+           std::regular_invocable<const F&, std::ranges::range_reference_t<V>> &&
+           detail::is_optional<std::invoke_result_t<const F&, std::ranges::range_reference_t<V>>>
+class checked_transform_view : public std::ranges::view_interface<checked_transform_view<V, F>> {
+  using result_t = typename std::invoke_result_t<const F&, std::ranges::range_reference_t<V>>::value_type;
+
+  class iterator {
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = result_t;
+    using difference_type = std::ranges::range_difference_t<V>;
+
+    constexpr explicit iterator(checked_transform_view& parent) :
+        parent_{&parent}, current_{std::ranges::begin(parent.base_)}, end_{std::ranges::end(parent.base_)} {
+      satisfy();
+    }
+
+    constexpr const value_type& operator*() const noexcept { return *value_; }
+
+    constexpr iterator& operator++() {
+      ++current_;
+      satisfy();
+      return *this;
+    }
+
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return !it.value_; }
+
+  private:
+    constexpr void satisfy() {
+      if (current_ == end_) {
+        value_.reset();
+        return;
+      }
+      value_ = std::invoke(*parent_->fn_, *current_);
+      if (!value_) parent_->failed_ = true;
+    }
+
+    checked_transform_view* parent_;
+    std::ranges::iterator_t<V> current_;
+    std::ranges::sentinel_t<V> end_;
+    std::optional<value_type> value_;
+  };
+
+public:
+  constexpr checked_transform_view(V base, F fn) : base_{std::move(base)}, fn_{std::move(fn)} {}
+
+  constexpr V base() const&
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  constexpr V base() && { return std::move(base_); }
+
+  constexpr iterator begin() {
+    failed_ = false;
+    return iterator{*this};
+  }
+
+  constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+  // True if the last iteration ended early because fn rejected an element,
+  // or because an upstream checked view failed
+  constexpr bool failed() const noexcept {
+    if constexpr (detail::reports_failure<V>)
+      if (base_.failed()) return true;
+    return failed_;
+  }
+
+private:
+  V base_;
+  detail::copyable_box<F> fn_;
+  bool failed_ = false;
+};
+
+template <typename R, typename F>
+checked_transform_view(R&&, F) -> checked_transform_view<std::views::all_t<R>, F>;
+
+// Yields the running sum of the elements, accumulated in the range's value
+// type. Ends at the first element whose addition fails can_add_in_place.
+template <std::ranges::input_range V>
+  requires std::ranges::view<V> && std::integral<std::ranges::range_value_t<V>>
+class checked_partial_sum_view : public std::ranges::view_interface<checked_partial_sum_view<V>> {
+  class iterator {
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = std::ranges::range_value_t<V>;
+    using difference_type = std::ranges::range_difference_t<V>;
+
+    constexpr explicit iterator(checked_partial_sum_view& parent) :
+        parent_{&parent}, current_{std::ranges::begin(parent.base_)}, end_{std::ranges::end(parent.base_)} {
+      if (current_ != end_) sum_ = static_cast<value_type>(*current_);
+    }
+
+    constexpr const value_type& operator*() const noexcept { return *sum_; }
+
+    constexpr iterator& operator++() {
+      if (++current_ == end_) {
+        sum_.reset();
+        return *this;
+      }
+
+      const value_type x = *current_;
+      if (::beman::bounds_test::can_add_in_place(*sum_, x)) {
+        sum_ = static_cast<value_type>(*sum_ + x);
+      } else {
+        sum_.reset();
+        parent_->failed_ = true;
+      }
+      return *this;
+    }
+
+    constexpr void operator++(int) { ++*this; }
+
+    friend constexpr bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return !it.sum_; }
+
+  private:
+    checked_partial_sum_view* parent_;
+    std::ranges::iterator_t<V> current_;
+    std::ranges::sentinel_t<V> end_;
+    std::optional<value_type> sum_;
+  };
+
+public:
+  constexpr explicit checked_partial_sum_view(V base) : base_{std::move(base)} {}
+
+  constexpr V base() const&
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  constexpr V base() && { return std::move(base_); }
+
+  constexpr iterator begin() {
+    failed_ = false;
+    return iterator{*this};
+  }
+
+  constexpr std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+  // True if the last iteration ended early because the running sum overflowed,
+  // or because an upstream checked view failed
+  constexpr bool failed() const noexcept {
+    if constexpr (detail::reports_failure<V>)
+      if (base_.failed()) return true;
+    return failed_;
+  }
+
+private:
+  V base_;
+  bool failed_ = false;
+};
+
+template <typename R>
+checked_partial_sum_view(R&&) -> checked_partial_sum_view<std::views::all_t<R>>;
+
+namespace detail {
+
+template <typename F>
+struct checked_transform_closure : range_adaptor_closure<checked_transform_closure<F>> {
+  F fn;
+
+  template <std::ranges::viewable_range R>
+  constexpr auto operator()(R&& r) const {
+    return checked_transform_view{std::views::all(std::forward<R>(r)), fn};
+  }
+};
+
+struct checked_transform_fn {
+  template <std::ranges::viewable_range R, typename F>
+  constexpr auto operator()(R&& r, F&& fn) const {
+    return checked_transform_view{std::views::all(std::forward<R>(r)), std::forward<F>(fn)};
+  }
+
+  template <typename F>
+  constexpr auto operator()(F&& fn) const {
+    return checked_transform_closure<std::decay_t<F>>{{}, std::forward<F>(fn)};
+  }
+};
+
+struct checked_partial_sum_fn : range_adaptor_closure<checked_partial_sum_fn> {
+  template <std::ranges::viewable_range R>
+  constexpr auto operator()(R&& r) const {
+    return checked_partial_sum_view{std::views::all(std::forward<R>(r))};
+  }
+};
+
+template <std::integral T>
+struct checked_cast_fn : range_adaptor_closure<checked_cast_fn<T>> {
+  template <std::ranges::viewable_range R>
+  constexpr auto operator()(R&& r) const {
+    return checked_transform_view{std::views::all(std::forward<R>(r)), try_convert<T>{}};
+  }
+};
+
+} // namespace detail
+
+namespace views {
+
+inline constexpr detail::checked_transform_fn checked_transform{};
+
+inline constexpr detail::checked_partial_sum_fn checked_partial_sum{};
+
+template <std::integral R>
+inline constexpr detail::checked_cast_fn<R> checked_cast{};
+
+} // namespace views
+
+} // namespace beman::bounds_test
+
+#endif // BEMAN_BOUNDS_TEST_VIEWS_HPP
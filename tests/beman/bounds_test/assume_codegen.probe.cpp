@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Compiled to assembly by assume_codegen_test.cmake. Each function repeats a
+// check after assuming it and returns the result, calling not_folded() unless
+// the optimizer has reduced that result to a constant, so the optimized
+// assembly must never mention not_folded.
+
+#include <beman/bounds_test/bounds_test.hpp>
+
+namespace bt = beman::bounds_test;
+
+void not_folded();
+
+inline bool require_folded(bool result) {
+  if (!__builtin_constant_p(result)) not_folded();
+  return result;
+}
+
+template <typename A, typename B>
+bool add(A a, B b) {
+  bt::assume_can_add(a, b);
+  return require_folded(bt::can_add(a, b));
+}
+
+template <typename A, typename B>
+bool subtract(A a, B b) {
+  bt::assume_can_subtract(a, b);
+  return require_folded(bt::can_subtract(a, b));
+}
+
+template <typename A, typename B>
+bool multiply(A a, B b) {
+  bt::assume_can_multiply(a, b);
+  return require_folded(bt::can_multiply(a, b));
+}
+
+template <typename A, typename B>
+bool divide(A a, B b) {
+  bt::assume_can_divide(a, b);
+  return require_folded(bt::can_divide(a, b));
+}
+
+template <typename A, typename B>
+bool add_in_place(A a, B b) {
+  bt::assume_can_add_in_place(a, b);
+  return require_folded(bt::can_add_in_place(a, b));
+}
+
+template <typename A, typename B>
+bool subtract_in_place(A a, B b) {
+  bt::assume_can_subtract_in_place(a, b);
+  return require_folded(bt::can_subtract_in_place(a, b));
+}
+
+template <typename A, typename B>
+bool multiply_in_place(A a, B b) {
+  bt::assume_can_multiply_in_place(a, b);
+  return require_folded(bt::can_multiply_in_place(a, b));
+}
+
+template bool add(int, int);
+template bool add(unsigned, unsigned);
+template bool add(long long, long long);
+template bool add(int, long long);
+template bool subtract(int, int);
+template bool subtract(unsigned, unsigned);
+template bool subtract(long long, long long);
+template bool divide(int, int);
+template bool add_in_place(short, short);
+template bool add_in_place(int, short);
+template bool subtract_in_place(short, short);
+
+// The generic backend checks multiplication with a chain of comparisons and
+// divisions. Assuming the chain holds does not let GCC fold a repeat of it,
+// since each comparison only holds on some of the paths through the chain.
+#ifndef BEMAN_BOUNDS_TEST_GENERIC_BACKEND
+template bool multiply(int, int);
+template bool multiply(unsigned, unsigned);
+template bool multiply(long long, long long);
+template bool multiply(unsigned long long, unsigned long long);
+template bool multiply_in_place(short, short);
+template bool multiply_in_place(int, int);
+#endif
@@ -0,0 +1,35 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+# Checks that a check repeated after the matching assume_can_* folds away in
+# an optimized build with the backend the build selected, by compiling
+# assume_codegen.probe.cpp to assembly and looking for calls to not_folded.
+#
+# Usage: cmake -DCXX=<compiler> -DINCLUDE_DIRS=<dir>|<dir>... -DWORK_DIR=<dir> -P assume_codegen_test.cmake
+
+set(probe ${CMAKE_CURRENT_LIST_DIR}/assume_codegen.probe.cpp)
+set(output ${WORK_DIR}/assume_codegen.probe.s)
+
+string(REPLACE "|" ";" include_dirs "${INCLUDE_DIRS}")
+set(flags)
+foreach(dir IN LISTS include_dirs)
+  list(APPEND flags -I${dir})
+  # See assume_codegen.probe.cpp for the checks this backend does not fold
+  if(dir MATCHES "/plat/generic$")
+    list(APPEND flags -DBEMAN_BOUNDS_TEST_GENERIC_BACKEND)
+  endif()
+endforeach()
+
+execute_process(
+  COMMAND ${CXX} -std=c++20 -O2 -DNDEBUG -S ${flags} ${probe} -o ${output}
+  RESULT_VARIABLE result
+  ERROR_VARIABLE errors
+)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "failed to compile ${probe}:\n${errors}")
+endif()
+
+file(READ ${output} assembly)
+string(FIND "${assembly}" "not_folded" position)
+if(NOT position EQUAL -1)
+  message(FATAL_ERROR "a check after assume_can_* was not folded, see the calls to not_folded in ${output}")
+endif()
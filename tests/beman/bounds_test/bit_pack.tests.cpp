@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#include <catch2/catch_all.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#ifdef __INTELLISENSE__
+#include <beman/bounds_test/bit_pack.hpp>
+#else
+import beman.bounds_test;
+#endif
+
+namespace bt = beman::bounds_test;
+
+template <typename T>
+using nl = std::numeric_limits<T>;
+
+TEST_CASE("max_required_bits unsigned", "[bt::max_required_bits]") {
+  STATIC_REQUIRE(bt::max_required_bits(std::span<const unsigned>{}) == 0);
+  STATIC_REQUIRE([] {
+    std::array<unsigned, 4> v{0, 3, 17, 2};
+    return bt::max_required_bits(std::span{v}) == 5;
+  }());
+}
+
+TEST_CASE("max_required_bits signed", "[bt::max_required_bits]") {
+  STATIC_REQUIRE([] {
+    std::array<int, 3> v{0, 0, 0};
+    return bt::max_required_bits(std::span{v}) == 1;
+  }());
+  STATIC_REQUIRE([] {
+    std::array<int, 3> v{5, -16, 2};
+    return bt::max_required_bits(std::span{v}) == 5;
+  }());
+  STATIC_REQUIRE([] {
+    std::array<signed char, 2> v{nl<signed char>::min(), 1};
+    return bt::max_required_bits(std::span{v}) == 8;
+  }());
+}
+
+TEMPLATE_TEST_CASE("max_required_bits is the largest required_bits", "[bt::max_required_bits]", short, unsigned) {
+  STATIC_REQUIRE([] {
+    std::array<TestType, 5> v{1, nl<TestType>::max(), 0, nl<TestType>::min(), 7};
+    int expected = 0;
+    for (auto x : v)
+      expected = expected < bt::required_bits(x) ? bt::required_bits(x) : expected;
+    return bt::max_required_bits(std::span{v}) == expected;
+  }());
+}
+
+TEST_CASE("can_pack", "[bt::can_pack]") {
+  STATIC_REQUIRE([] {
+    std::array<int, 3> v{-4, 3, 0};
+    return bt::can_pack<3>(std::span{v}) && !bt::can_pack<2>(std::span{v});
+  }());
+}
+
+TEST_CASE("packed_words", "[bt::packed_words]") {
+  STATIC_REQUIRE(bt::packed_words(0, 7) == 0);
+  STATIC_REQUIRE(bt::packed_words(1, 7) == 7 * bt::pack_lanes);
+  STATIC_REQUIRE(bt::packed_words(bt::pack_block_size, 7) == 7 * bt::pack_lanes);
+  STATIC_REQUIRE(bt::packed_words(bt::pack_block_size + 1, 7) == 14 * bt::pack_lanes);
+  STATIC_REQUIRE(bt::packed_words(1000, 0) == 0);
+}
+
+template <int N, typename T>
+void require_round_trip(const std::vector<T>& in) {
+  std::vector<std::uint64_t> words(bt::packed_words(in.size(), N));
+  REQUIRE(bt::pack_bits<N>(std::span{in}, std::span{words}));
+
+  std::vector<T> out(in.size());
+  REQUIRE(bt::unpack_bits<N>(std::span<const std::uint64_t>{words}, std::span{out}));
+  REQUIRE(out == in);
+}
+
+TEST_CASE("pack_bits round trips unsigned values", "[bt::pack_bits][bt::unpack_bits]") {
+  std::vector<std::uint32_t> in(1000);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    in[i] = static_cast<std::uint32_t>(i * 2654435761u) & 0x1fff;
+
+  require_round_trip<13>(in);
+  require_round_trip<17>(in);
+  require_round_trip<32>(in);
+}
+
+TEST_CASE("pack_bits round trips signed values", "[bt::pack_bits][bt::unpack_bits]") {
+  std::vector<std::int64_t> in(700);
+  for (std::size_t i = 0; i < in.size(); ++i)
+    in[i] = static_cast<std::int64_t>(i * 40503u % 2048) - 1024;
+
+  require_round_trip<11>(in);
+  require_round_trip<12>(in);
+  require_round_trip<64>(in);
+}
+
+TEST_CASE("pack_bits round trips full-width values", "[bt::pack_bits][bt::unpack_bits]") {
+  std::vector<signed char> small{nl<signed char>::min(), -1, 0, 1, nl<signed char>::max()};
+  require_round_trip<8>(small);
+
+  std::vector<std::uint64_t> wide{0, 1, nl<std::uint64_t>::max(), nl<std::uint64_t>::max() / 3};
+  require_round_trip<64>(wide);
+}
+
+TEST_CASE("pack_bits with zero bits", "[bt::pack_bits][bt::unpack_bits]") {
+  require_round_trip<0>(std::vector<unsigned>(10, 0));
+
+  std::vector<unsigned> out(3, 7);
+  REQUIRE(bt::unpack_bits<0>(std::span<const std::uint64_t>{}, std::span{out}));
+  REQUIRE(out == std::vector<unsigned>(3, 0));
+}
+
+TEST_CASE("pack_bits rejects values that do not fit", "[bt::pack_bits]") {
+  std::vector<int> in{1, 2, -5, 3};
+  std::vector<std::uint64_t> words(bt::packed_words(in.size(), 4), 42);
+  REQUIRE_FALSE(bt::pack_bits<3>(std::span{in}, std::span{words}));
+  REQUIRE(words == std::vector<std::uint64_t>(words.size(), 42));
+  REQUIRE(bt::pack_bits<4>(std::span{in}, std::span{words}));
+}
+
+TEST_CASE("pack_bits and unpack_bits reject short buffers", "[bt::pack_bits][bt::unpack_bits]") {
+  std::vector<unsigned> in(10, 1);
+  std::vector<std::uint64_t> words(bt::packed_words(in.size(), 1) - 1);
+  REQUIRE_FALSE(bt::pack_bits<1>(std::span{in}, std::span{words}));
+  REQUIRE_FALSE(bt::unpack_bits<1>(std::span<const std::uint64_t>{words}, std::span{in}));
+}
+
+TEST_CASE("pack_bits is usable in constant expressions", "[bt::pack_bits][bt::unpack_bits]") {
+  STATIC_REQUIRE([] {
+    std::array<short, 5> in{-3, 2, 0, -1, 1};
+    std::array<std::uint64_t, 3 * bt::pack_lanes> words{};
+    std::array<short, 5> out{};
+    return bt::pack_bits<3>(std::span{in}, std::span{words}) &&
+           bt::unpack_bits<3>(std::span<const std::uint64_t>{words}, std::span{out}) && in == out;
+  }());
+}
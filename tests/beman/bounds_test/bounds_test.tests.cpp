@@ -1,8 +1,11 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 #include <catch2/catch_all.hpp>
+#include <array>
+#include <cstddef>
 #include <limits>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #ifdef __INTELLISENSE__
 #include <beman/bounds_test/bounds_test.hpp>
@@ -56,6 +59,41 @@ TEST_CASE("can_convert_modular always returns true", "[bt::can_convert_modular]"
   STATIC_REQUIRE(bt::can_convert_modular<int>(0));
 }
 
+TEST_CASE("required_bits unsigned", "[bt::required_bits]") {
+  STATIC_REQUIRE(bt::required_bits(0u) == 0);
+  STATIC_REQUIRE(bt::required_bits(1u) == 1);
+  STATIC_REQUIRE(bt::required_bits(255u) == 8);
+  STATIC_REQUIRE(bt::required_bits(256u) == 9);
+  STATIC_REQUIRE(bt::required_bits(nl<unsigned long long>::max()) == 64);
+}
+
+TEST_CASE("required_bits signed", "[bt::required_bits]") {
+  STATIC_REQUIRE(bt::required_bits(0) == 1);
+  STATIC_REQUIRE(bt::required_bits(-1) == 1);
+  STATIC_REQUIRE(bt::required_bits(1) == 2);
+  STATIC_REQUIRE(bt::required_bits(127) == 8);
+  STATIC_REQUIRE(bt::required_bits(-128) == 8);
+  STATIC_REQUIRE(bt::required_bits(128) == 9);
+  STATIC_REQUIRE(bt::required_bits(-129) == 9);
+  STATIC_REQUIRE(bt::required_bits(nl<long long>::min()) == 64);
+}
+
+TEMPLATE_TEST_CASE("can_fit_bits at the type's own width", "[bt::can_fit_bits]", ALL_TYPES) {
+  constexpr int bits = nl<TestType>::digits + nl<TestType>::is_signed;
+  STATIC_REQUIRE(bt::can_fit_bits<bits>(nl<TestType>::min()));
+  STATIC_REQUIRE(bt::can_fit_bits<bits>(nl<TestType>::max()));
+  STATIC_REQUIRE_FALSE(bt::can_fit_bits<bits - 1>(nl<TestType>::max()));
+  STATIC_REQUIRE(bt::can_fit_bits<1>(TestType{0}));
+}
+
+TEST_CASE("can_fit_bits matches can_convert", "[bt::can_fit_bits]") {
+  STATIC_REQUIRE(bt::can_fit_bits<8>(-128) == bt::can_convert<signed char>(-128));
+  STATIC_REQUIRE(bt::can_fit_bits<8>(128) == bt::can_convert<signed char>(128));
+  STATIC_REQUIRE(bt::can_fit_bits<16>(65535u) == bt::can_convert<unsigned short>(65535u));
+  STATIC_REQUIRE(bt::can_fit_bits<16>(65536u) == bt::can_convert<unsigned short>(65536u));
+  STATIC_REQUIRE_FALSE(bt::can_fit_bits<0>(1u));
+}
+
 TEMPLATE_TEST_CASE("can_increment", "[bt::can_increment]", ALL_TYPES) {
   STATIC_REQUIRE(bt::can_increment(nl<TestType>::min()));
   STATIC_REQUIRE_FALSE(bt::can_increment(nl<TestType>::max()));
@@ -222,6 +260,156 @@ TEMPLATE_LIST_TEST_CASE("can_multiply signed no promote", "[bt::can_multiply]",
   STATIC_REQUIRE_FALSE(bt::can_multiply(lmin, TestType{-1}));
 }
 
+// Backends may take a different path outside of constant evaluation, so check
+// that the runtime results agree with the constant-evaluated ones
+template <typename T>
+constexpr auto boundary_values = std::array<T, 8>{
+    nl<T>::min(),
+    static_cast<T>(nl<T>::min() + 1),
+    static_cast<T>(-1),
+    T{0},
+    T{1},
+    T{2},
+    static_cast<T>(nl<T>::max() - 1),
+    nl<T>::max(),
+};
+
+template <typename T, int... N>
+constexpr bool fit_bits_matches_required_bits(std::integer_sequence<int, N...>) {
+  for (T v : boundary_values<T>)
+    if (((bt::can_fit_bits<N>(v) != (bt::required_bits(v) <= N)) || ...)) return false;
+  return true;
+}
+
+TEMPLATE_TEST_CASE("can_fit_bits matches required_bits at every width", "[bt::can_fit_bits]", ALL_TYPES) {
+  STATIC_REQUIRE(fit_bits_matches_required_bits<TestType>(std::make_integer_sequence<int, 66>{}));
+}
+
+template <typename T>
+constexpr bool has_bit_width_queries = requires(T v) {
+  bt::required_bits(v);
+  bt::can_fit_bits<1>(v);
+};
+
+TEST_CASE("bit-width queries reject bool", "[bt::required_bits]") {
+  STATIC_REQUIRE(has_bit_width_queries<int>);
+  STATIC_REQUIRE_FALSE(has_bit_width_queries<bool>);
+}
+
+template <typename T, typename U, typename Check>
+constexpr auto constant_results(Check check) {
+  constexpr auto& v = boundary_values<T>;
+  constexpr auto& w = boundary_values<U>;
+  std::array<bool, v.size() * w.size()> results{};
+  for (std::size_t i = 0; i < v.size(); ++i)
+    for (std::size_t j = 0; j < w.size(); ++j)
+      results[i * w.size() + j] = check(v[i], w[j]);
+  return results;
+}
+
+template <typename T, typename U = T, typename Check>
+void require_runtime_matches(Check check) {
+  static constexpr auto expected = constant_results<T, U>(check);
+  const auto v = boundary_values<T>;
+  const auto w = boundary_values<U>;
+  for (std::size_t i = 0; i < v.size(); ++i)
+    for (std::size_t j = 0; j < w.size(); ++j)
+      REQUIRE(check(v[i], w[j]) == expected[i * w.size() + j]);
+}
+
+// In-place checks take the result type from the first operand, so these cover
+// operands that widen losslessly to it as well as ones that do not
+template <typename T, typename U>
+void require_runtime_matches_in_place() {
+  require_runtime_matches<T, U>([](auto a, auto b) { return bt::can_add_in_place(a, b); });
+  require_runtime_matches<T, U>([](auto a, auto b) { return bt::can_subtract_in_place(a, b); });
+  require_runtime_matches<T, U>([](auto a, auto b) { return bt::can_multiply_in_place(a, b); });
+}
+
+TEST_CASE("runtime mixed-type in-place checks match constant evaluation", "[bt::can_add_in_place]") {
+  require_runtime_matches_in_place<int, short>();
+  require_runtime_matches_in_place<int, unsigned short>();
+  require_runtime_matches_in_place<long long, unsigned>();
+  require_runtime_matches_in_place<unsigned, unsigned char>();
+  require_runtime_matches_in_place<short, signed char>();
+  require_runtime_matches_in_place<short, int>();
+}
+
+TEMPLATE_TEST_CASE("runtime can_add matches constant evaluation", "[bt::can_add]", ALL_TYPES) {
+  require_runtime_matches<TestType>([](auto a, auto b) { return bt::can_add(a, b); });
+  require_runtime_matches<TestType>([](auto a, auto b) { return bt::can_add_in_place(a, b); });
+}
+
+TEMPLATE_TEST_CASE("runtime can_subtract matches constant evaluation", "[bt::can_subtract]", ALL_TYPES) {
+  require_runtime_matches<TestType>([](auto a, auto b) { return bt::can_subtract(a, b); });
+  require_runtime_matches<TestType>([](auto a, auto b) { return bt::can_subtract_in_place(a, b); });
+}
+
+TEMPLATE_TEST_CASE("runtime can_multiply matches constant evaluation", "[bt::can_multiply]", ALL_TYPES) {
+  require_runtime_matches<TestType>([](auto a, auto b) { return bt::can_multiply(a, b); });
+  require_runtime_matches<TestType>([](auto a, auto b) { return bt::can_multiply_in_place(a, b); });
+}
+
+TEMPLATE_TEST_CASE("can_muldiv unsigned", "[bt::can_muldiv]", UNSIGNED_TYPES) {
+  using result_t = decltype(TestType{} * TestType{} / TestType{});
+  constexpr auto lmax = nl<result_t>::max();
+  STATIC_REQUIRE(bt::can_muldiv(result_t{0}, TestType{0}, TestType{1}));
+  STATIC_REQUIRE(bt::can_muldiv(result_t{lmax}, result_t{lmax}, result_t{lmax}));
+  STATIC_REQUIRE(bt::can_muldiv(result_t{lmax}, TestType{2}, TestType{2}));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(result_t{lmax}, TestType{2}, TestType{1}));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(result_t{1}, TestType{1}, TestType{0}));
+}
+
+TEMPLATE_TEST_CASE("can_muldiv signed", "[bt::can_muldiv]", SIGNED_TYPES) {
+  using result_t = decltype(TestType{} * TestType{} / TestType{});
+  constexpr auto lmin = nl<result_t>::min();
+  constexpr auto lmax = nl<result_t>::max();
+  STATIC_REQUIRE(bt::can_muldiv(result_t{0}, TestType{0}, TestType{1}));
+  STATIC_REQUIRE(bt::can_muldiv(result_t{lmax}, result_t{lmax}, result_t{lmax}));
+  STATIC_REQUIRE(bt::can_muldiv(result_t{lmin}, result_t{lmin}, result_t{lmin}));
+  STATIC_REQUIRE(bt::can_muldiv(result_t{lmin}, TestType{-1}, TestType{-1}));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(result_t{lmin}, TestType{1}, TestType{-1}));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(result_t{lmax}, TestType{2}, TestType{1}));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(result_t{1}, TestType{1}, TestType{0}));
+}
+
+TEST_CASE("can_muldiv rounding can overflow", "[bt::can_muldiv]") {
+  // 65535 * 65537 / 2 == INT_MAX + 0.5
+  STATIC_REQUIRE(bt::can_muldiv(65535, 65537, 2));
+  STATIC_REQUIRE(bt::can_muldiv(65535, 65537, 2, bt::rounding::floor));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(65535, 65537, 2, bt::rounding::nearest));
+
+  // -641 * 6700417 / 2 == INT_MIN - 0.5
+  STATIC_REQUIRE(bt::can_muldiv(-641, 6700417, 2));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(-641, 6700417, 2, bt::rounding::floor));
+  STATIC_REQUIRE_FALSE(bt::can_muldiv(-641, 6700417, 2, bt::rounding::nearest));
+}
+
+TEST_CASE("try_muldiv rounding", "[bt::try_muldiv]") {
+  STATIC_REQUIRE(bt::try_muldiv(7, 1, 2) == 3);
+  STATIC_REQUIRE(bt::try_muldiv(-7, 1, 2) == -3);
+  STATIC_REQUIRE(bt::try_muldiv(7, 1, 2, bt::rounding::floor) == 3);
+  STATIC_REQUIRE(bt::try_muldiv(-7, 1, 2, bt::rounding::floor) == -4);
+  STATIC_REQUIRE(bt::try_muldiv(7, -1, -2, bt::rounding::floor) == 3);
+  STATIC_REQUIRE(bt::try_muldiv(7, 1, 2, bt::rounding::nearest) == 4);
+  STATIC_REQUIRE(bt::try_muldiv(-7, 1, 2, bt::rounding::nearest) == -4);
+  STATIC_REQUIRE(bt::try_muldiv(4, 1, 3, bt::rounding::nearest) == 1);
+  STATIC_REQUIRE(bt::try_muldiv(5, 1, 3, bt::rounding::nearest) == 2);
+}
+
+TEST_CASE("try_muldiv uses a wide intermediate", "[bt::try_muldiv]") {
+  constexpr auto smax = nl<long long>::max();
+  constexpr auto smin = nl<long long>::min();
+  constexpr auto umax = nl<unsigned long long>::max();
+  STATIC_REQUIRE(bt::try_muldiv(smax, smax, smax) == smax);
+  STATIC_REQUIRE(bt::try_muldiv(smin, -3LL, -3LL) == smin);
+  STATIC_REQUIRE(bt::try_muldiv(umax, 1000ULL, 1000ULL) == umax);
+  STATIC_REQUIRE(bt::try_muldiv(umax, umax, umax) == umax);
+  STATIC_REQUIRE(bt::try_muldiv(1'000'000'007LL, 3'000'000'000LL, 7LL) == 428'571'431'571'428'571LL);
+  STATIC_REQUIRE_FALSE(bt::try_muldiv(smin, 1LL, -1LL).has_value());
+  STATIC_REQUIRE_FALSE(bt::try_muldiv(umax, 2ULL, 1ULL).has_value());
+}
+
 TEST_CASE("can_take_remainder is can_divide", "[bt::can_take_remainder]") {
   STATIC_REQUIRE_FALSE(bt::can_take_remainder(0, 0));
 }
@@ -375,3 +563,46 @@ TEST_CASE("can_bitwise_xor_in_place_modular is always true", "[bt::can_bitwise_x
 TEST_CASE("can_bitwise_or_in_place_modular is always true", "[bt::can_bitwise_or_in_place_modular]") {
   STATIC_REQUIRE(bt::can_bitwise_or_in_place_modular(0, 0));
 }
+
+TEST_CASE("assume_can_* accepts operands that pass the check", "[bt::assume_can]") {
+  STATIC_REQUIRE([] {
+    bt::assume_can_convert<unsigned char>(255);
+    bt::assume_can_increment(nl<int>::max() - 1);
+    bt::assume_can_decrement(nl<int>::min() + 1);
+    bt::assume_can_negate(nl<int>::max());
+    bt::assume_can_add(nl<int>::max(), -1);
+    bt::assume_can_subtract(nl<int>::min(), -1);
+    bt::assume_can_multiply(nl<int>::max(), -1);
+    bt::assume_can_divide(nl<int>::min(), 1);
+    bt::assume_can_add_in_place(nl<short>::max(), -1);
+    bt::assume_can_subtract_in_place(nl<short>::min(), -1);
+    bt::assume_can_multiply_in_place(nl<short>::max(), -1);
+    bt::assume_can_divide_in_place(nl<short>::min(), 1);
+    return true;
+  }());
+
+  int a = nl<int>::max();
+  bt::assume_can_add(a, -1);
+  REQUIRE(bt::can_add(a, -1));
+}
+
+TEMPLATE_TEST_CASE("expect_can_* returns the check", "[bt::expect_can]", ALL_TYPES) {
+  constexpr auto& v = boundary_values<TestType>;
+  STATIC_REQUIRE(bt::expect_can_convert<signed char>(v[0]) == bt::can_convert<signed char>(v[0]));
+  STATIC_REQUIRE(bt::expect_can_increment(v[7]) == bt::can_increment(v[7]));
+  STATIC_REQUIRE(bt::expect_can_decrement(v[0]) == bt::can_decrement(v[0]));
+  STATIC_REQUIRE(bt::expect_can_negate(v[0]) == bt::can_negate(v[0]));
+
+  for (auto a : v) {
+    for (auto b : v) {
+      REQUIRE(bt::expect_can_add(a, b) == bt::can_add(a, b));
+      REQUIRE(bt::expect_can_subtract(a, b) == bt::can_subtract(a, b));
+      REQUIRE(bt::expect_can_multiply(a, b) == bt::can_multiply(a, b));
+      REQUIRE(bt::expect_can_divide(a, b) == bt::can_divide(a, b));
+      REQUIRE(bt::expect_can_add_in_place(a, b) == bt::can_add_in_place(a, b));
+      REQUIRE(bt::expect_can_subtract_in_place(a, b) == bt::can_subtract_in_place(a, b));
+      REQUIRE(bt::expect_can_multiply_in_place(a, b) == bt::can_multiply_in_place(a, b));
+      REQUIRE(bt::expect_can_divide_in_place(a, b) == bt::can_divide_in_place(a, b));
+    }
+  }
+}
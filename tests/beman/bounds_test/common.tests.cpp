@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <limits>
+
+// The portable double-word helpers are only used by compilers without a
+// 128-bit type, so they are tested directly here
+#include <beman/bounds_test/plat/common.hpp>
+
+namespace detail = beman::bounds_test::detail;
+
+using u64 = std::uint64_t;
+
+constexpr u64 max64 = std::numeric_limits<u64>::max();
+
+struct wide {
+  u64 hi;
+  u64 lo;
+
+  friend constexpr bool operator==(const wide&, const wide&) = default;
+};
+
+constexpr wide umul(u64 a, u64 b) {
+  wide r{};
+  detail::umul_wide(a, b, r.hi, r.lo);
+  return r;
+}
+
+// True if udiv_wide returns the expected quotient and remainder, and they
+// satisfy q * d + r == hi:lo with r < d
+constexpr bool divides(u64 hi, u64 lo, u64 d, u64 q, u64 r) {
+  u64 rem = 0;
+  const u64 quot = detail::udiv_wide(hi, lo, d, rem);
+  if (quot != q || rem != r || rem >= d) return false;
+
+  wide p = umul(quot, d);
+  p.lo += rem;
+  p.hi += p.lo < rem;
+  return p == wide{hi, lo};
+}
+
+TEST_CASE("umul_wide", "[detail::umul_wide]") {
+  STATIC_REQUIRE(umul(0, max64) == wide{0, 0});
+  STATIC_REQUIRE(umul(1, max64) == wide{0, max64});
+  STATIC_REQUIRE(umul(u64{1} << 32, u64{1} << 32) == wide{1, 0});
+  STATIC_REQUIRE(umul(max64, max64) == wide{max64 - 1, 1});
+  // Every partial product carries into the middle word
+  STATIC_REQUIRE(umul(0xffff'ffff'ffff'ffff, 0x1'0000'0001) == wide{0x1'0000'0000, 0xffff'fffe'ffff'ffff});
+  STATIC_REQUIRE(umul(0x8000'0000'8000'0000, 0x8000'0000'8000'0000) ==
+                 wide{0x4000'0000'8000'0000, 0x4000'0000'0000'0000});
+}
+
+TEST_CASE("udiv_wide with an already normalized divisor", "[detail::udiv_wide]") {
+  // The divisor's top bit is set, so the shift s is 0
+  STATIC_REQUIRE(divides(0, 0, max64, 0, 0));
+  STATIC_REQUIRE(divides(max64 - 1, max64, max64, max64, max64 - 1));
+  STATIC_REQUIRE(divides(0x7fff'ffff'ffff'ffff, max64, u64{1} << 63, max64, (u64{1} << 63) - 1));
+  STATIC_REQUIRE(divides(0x197d'0ba7'6eea'8310, 0xffff'ffff'ebb4'b3a4, 0x8569'f779'd970'a364,
+                         0x30e8'84d2'7193'39f0, 0x2b55'b085'074e'41e4));
+}
+
+TEST_CASE("udiv_wide with a divisor of one", "[detail::udiv_wide]") {
+  // The shift s is 63, and hi must be 0
+  STATIC_REQUIRE(divides(0, 0, 1, 0, 0));
+  STATIC_REQUIRE(divides(0, max64, 1, max64, 0));
+  STATIC_REQUIRE(divides(0, 0x1234'5678'9abc'def0, 1, 0x1234'5678'9abc'def0, 0));
+}
+
+TEST_CASE("udiv_wide quotient digit corrections", "[detail::udiv_wide]") {
+  // The estimates of both the high and low quotient digits are one too large
+  STATIC_REQUIRE(divides(0x2595'4414'f966, 0x0561'd805'7935'c08e, 0x8916'f57e'eda1, 0x462e'a99c'db86'f323,
+                         0x2205'5005'708b));
+  // The estimate of the high quotient digit is two too large
+  STATIC_REQUIRE(divides(0x169'e2c5'8537, 0x2ced'bfd4'd72d'e584, 0x20c'5abc'a33c, 0xb0ad'ff19'f09e'd10d,
+                         0xcf'3b4d'9f78));
+  // The estimate of the low quotient digit is two too large
+  STATIC_REQUIRE(divides(0x197d'0ba7'6eea'8310, 0xffff'ffff'ebb4'b3a4, 0x42b4'fbbc'ecb8'51b2, 0x61d1'09a4'e326'73e0,
+                         0x2b55'b085'074e'41e4));
+  // The first quotient digit estimate is at least 2^32
+  STATIC_REQUIRE(divides(0xffff'fffe, max64, 0xffff'ffff, max64, 0xffff'fffe));
+}
+
+TEST_CASE("mul_div_wide matches the portable helpers", "[detail::mul_div_wide]") {
+  // mul_div_wide uses a native 128-bit type where there is one, and must
+  // agree with umul_wide and udiv_wide
+  constexpr u64 values[] = {1, 2, 3, 0xffff'ffff, u64{1} << 32, 0x8000'0000'0000'0001, 0x1234'5678'9abc'def1, max64};
+  for (u64 a : values)
+    for (u64 b : values)
+      for (u64 c : values) {
+        const wide p = umul(a, b);
+        u64 q = 0, r = 0;
+        const bool fits = detail::mul_div_wide(a, b, c, q, r);
+        CHECK(fits == (p.hi < c));
+        if (!fits) continue;
+
+        u64 expected_r = 0;
+        CHECK(q == detail::udiv_wide(p.hi, p.lo, c, expected_r));
+        CHECK(r == expected_r);
+        CHECK(divides(p.hi, p.lo, c, q, r));
+      }
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#include <catch2/catch_all.hpp>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <ranges>
+
+#ifdef __INTELLISENSE__
+#include <beman/bounds_test/views.hpp>
+#else
+import beman.bounds_test;
+#endif
+
+namespace bt = beman::bounds_test;
+
+template <typename T>
+using nl = std::numeric_limits<T>;
+
+template <typename R, typename T, std::size_t N>
+constexpr bool yields(R&& r, const std::array<T, N>& expected) {
+  std::size_t i = 0;
+  for (auto&& v : r) {
+    if (i == N || v != expected[i]) return false;
+    ++i;
+  }
+  return i == N;
+}
+
+constexpr auto try_double = [](int x) -> std::optional<int> {
+  if (!bt::can_multiply(x, 2)) return std::nullopt;
+  return x * 2;
+};
+
+TEST_CASE("checked_transform yields every element when all checks pass", "[bt::views::checked_transform]") {
+  STATIC_REQUIRE([] {
+    std::array in{1, -2, 3};
+    auto v = in | bt::views::checked_transform(try_double);
+    return yields(v, std::array{2, -4, 6}) && !v.failed();
+  }());
+
+  STATIC_REQUIRE([] {
+    std::array in{1, -2, 3};
+    auto v = bt::views::checked_transform(in, try_double);
+    return yields(v, std::array{2, -4, 6}) && !v.failed();
+  }());
+}
+
+TEST_CASE("checked_transform stops at the first failing element", "[bt::views::checked_transform]") {
+  STATIC_REQUIRE([] {
+    std::array in{1, nl<int>::max(), 3};
+    auto v = in | bt::views::checked_transform(try_double);
+    return yields(v, std::array{2}) && v.failed();
+  }());
+
+  STATIC_REQUIRE([] {
+    std::array in{nl<int>::min(), 1};
+    auto v = in | bt::views::checked_transform(try_double);
+    return v.begin() == v.end() && v.failed();
+  }());
+}
+
+TEST_CASE("checked_transform is lazy", "[bt::views::checked_transform]") {
+  STATIC_REQUIRE([] {
+    std::array in{1, 2, nl<int>::max(), 4, 5};
+    int calls = 0;
+    auto counted = [&calls](int x) {
+      ++calls;
+      return try_double(x);
+    };
+    auto v = in | bt::views::checked_transform(counted);
+    if (calls != 0) return false;
+    for (auto x : v)
+      (void)x;
+    return calls == 3;
+  }());
+}
+
+TEST_CASE("checked_partial_sum", "[bt::views::checked_partial_sum]") {
+  STATIC_REQUIRE([] {
+    std::array in{1, 2, 3, 4};
+    auto v = in | bt::views::checked_partial_sum;
+    return yields(v, std::array{1, 3, 6, 10}) && !v.failed();
+  }());
+
+  STATIC_REQUIRE([] {
+    std::array<signed char, 4> in{100, 27, 1, -128};
+    auto v = bt::views::checked_partial_sum(in);
+    return yields(v, std::array<signed char, 2>{100, 127}) && v.failed();
+  }());
+
+  STATIC_REQUIRE([] {
+    std::array<int, 0> in{};
+    auto v = in | bt::views::checked_partial_sum;
+    return v.begin() == v.end() && !v.failed();
+  }());
+}
+
+TEST_CASE("checked_cast", "[bt::views::checked_cast]") {
+  STATIC_REQUIRE([] {
+    std::array in{0, 255, 256, 1};
+    auto v = in | bt::views::checked_cast<unsigned char>;
+    return yields(v, std::array<unsigned char, 2>{0, 255}) && v.failed();
+  }());
+
+  STATIC_REQUIRE([] {
+    std::array in{-1};
+    auto v = in | bt::views::checked_cast<unsigned>;
+    return v.begin() == v.end() && v.failed();
+  }());
+}
+
+TEST_CASE("checked views compose", "[bt::views]") {
+  STATIC_REQUIRE([] {
+    std::array in{1, 2, 3, 1000};
+    auto v = in | bt::views::checked_transform(try_double) | bt::views::checked_partial_sum |
+             bt::views::checked_cast<signed char>;
+    return yields(v, std::array<signed char, 3>{2, 6, 12}) && v.failed();
+  }());
+
+  STATIC_REQUIRE([] {
+    auto v = std::views::iota(1, 5) | bt::views::checked_partial_sum | std::views::take(3);
+    return yields(v, std::array{1, 3, 6});
+  }());
+}
+
+TEST_CASE("checked views report failures from upstream stages", "[bt::views]") {
+  STATIC_REQUIRE([] {
+    std::array in{1, nl<int>::max(), 3};
+    auto v = in | bt::views::checked_transform(try_double) | bt::views::checked_partial_sum;
+    return yields(v, std::array{2}) && v.failed() && v.base().failed();
+  }());
+
+  // The failure passes through a stage that did not fail itself
+  STATIC_REQUIRE([] {
+    std::array in{1000, 2, -1};
+    auto v = in | bt::views::checked_cast<unsigned char> | bt::views::checked_transform(try_double) |
+             bt::views::checked_partial_sum;
+    return yields(v, std::array<unsigned char, 0>{}) && v.failed();
+  }());
+
+  STATIC_REQUIRE([] {
+    std::array in{1, 2, 3};
+    auto v = in | bt::views::checked_transform(try_double) | bt::views::checked_partial_sum;
+    return yields(v, std::array{2, 6, 12}) && !v.failed();
+  }());
+}
+
+TEST_CASE("checked views are input views", "[bt::views]") {
+  std::array in{1, 2};
+  using transform_t = decltype(in | bt::views::checked_transform(try_double));
+  using partial_sum_t = decltype(in | bt::views::checked_partial_sum);
+  STATIC_REQUIRE(std::ranges::view<transform_t> && std::ranges::input_range<transform_t>);
+  STATIC_REQUIRE(std::ranges::view<partial_sum_t> && std::ranges::input_range<partial_sum_t>);
+}